@@ -0,0 +1,70 @@
+#include <tinyevents/recorder.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using namespace tinyevents;
+
+namespace {
+    struct Tick {
+        std::uint64_t frame;
+        double time;
+    };
+
+    constexpr std::uint32_t TickEvent = 1;
+
+    using Clock = std::chrono::steady_clock;
+
+    void report(const char *name, const std::size_t events, const Clock::duration elapsed) {
+        const double seconds = std::chrono::duration<double>(elapsed).count();
+        std::printf("%-10s %10zu events %10.3f ms %12.0f events/s\n",
+                    name, events, seconds * 1000.0, static_cast<double>(events) / seconds);
+    }
+}
+
+// Usage: tinyevents_benchmarks [events] [replays]
+int main(int argc, char *argv[]) {
+    const std::size_t events = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    const std::size_t replays = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10;
+    const std::string path = "tinyevents_benchmark.bin";
+
+    std::uint64_t checksum = 0;
+    const auto sumFrames = [&checksum](const Tick &tick) {
+        checksum += tick.frame;
+    };
+
+    {
+        Dispatcher dispatcher;
+        dispatcher.listen<Tick>(sumFrames);
+        Recorder recorder(dispatcher, path);
+        recorder.record<Tick>(TickEvent);
+
+        const auto start = Clock::now();
+        for (std::size_t i = 0; i < events; ++i) {
+            dispatcher.dispatch(Tick{i, static_cast<double>(i) * 0.016});
+        }
+        recorder.flush();
+        report("record", events, Clock::now() - start);
+    }
+
+    Dispatcher dispatcher;
+    dispatcher.listen<Tick>(sumFrames);
+
+    const auto loadStart = Clock::now();
+    Replayer replayer(path);
+    replayer.on<Tick>(TickEvent);
+    report("load", events, Clock::now() - loadStart);
+
+    const auto replayStart = Clock::now();
+    std::size_t replayed = 0;
+    for (std::size_t i = 0; i < replays; ++i) {
+        replayed += replayer.replay(dispatcher);
+    }
+    report("replay", replayed, Clock::now() - replayStart);
+
+    std::remove(path.c_str());
+    std::printf("checksum %llu\n", static_cast<unsigned long long>(checksum));
+    return 0;
+}
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <tinyevents/tinyevents.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace tinyevents
+{
+    // Binary log layout (native endianness):
+    //   header: magic "TEVR", u32 version
+    //   record: u32 typeId, u32 payloadSize, u64 timestamp [ns since recording started], payload
+    namespace eventlog
+    {
+        constexpr char Magic[4] = {'T', 'E', 'V', 'R'};
+        constexpr std::uint32_t Version = 1;
+
+        struct RecordHeader {
+            std::uint32_t typeId;
+            std::uint32_t payloadSize;
+            std::uint64_t timestamp;
+        };
+
+        constexpr std::size_t FileHeaderSize = sizeof(Magic) + sizeof(Version);
+    }// namespace eventlog
+
+    // Appends every dispatch of the recorded types to a binary log file. An event is written before
+    // any listener runs. Events dispatched while a recorded event is being dispatched are not written,
+    // because replaying the recorded event produces them again.
+    // Events are buffered in memory and written to the file in large chunks.
+    class Recorder {
+        static constexpr std::size_t FlushThreshold = 64 * 1024;
+    public:
+        Recorder(Dispatcher& dispatcher, const std::string& path)
+            : dispatcher(dispatcher), file(path, std::ios::binary | std::ios::trunc),
+              startTime(std::chrono::steady_clock::now()) {
+            if (!file) {
+                throw std::runtime_error("tinyevents: cannot open log file for writing: " + path);
+            }
+            buffer.reserve(FlushThreshold * 2);
+            append(eventlog::Magic, sizeof(eventlog::Magic));
+            append(&eventlog::Version, sizeof(eventlog::Version));
+        }
+
+        // Errors cannot be reported from here. Call flush() before destruction to detect them.
+        ~Recorder() {
+            writeBuffer();
+        }
+
+        Recorder(const Recorder&) = delete;
+        Recorder& operator=(const Recorder&) = delete;
+
+        // Record events of a trivially copyable type. The event is stored as its raw bytes.
+        template<typename T>
+        void record(const std::uint32_t typeId) {
+            static_assert(std::is_trivially_copyable_v<T>, "Event must be trivially copyable or have a serializer");
+            tokens.emplace_back(dispatcher, dispatcher.observe<T>([this, typeId](const T& msg) {
+                write(typeId, &msg, sizeof(T));
+            }));
+        }
+
+        // Record events using a custom serializer. The serializer appends the event bytes to `out`.
+        template<typename T>
+        void record(const std::uint32_t typeId, const std::function<void(std::string& out, const T&)>& serializer) {
+            tokens.emplace_back(dispatcher, dispatcher.observe<T>([this, typeId, serializer](const T& msg) {
+                scratch.clear();
+                serializer(scratch, msg);
+                write(typeId, scratch.data(), scratch.size());
+            }));
+        }
+
+        // Write buffered events to the file. Throws std::runtime_error if recording has failed,
+        // either now or earlier while dispatching; recording stops at the first failure.
+        void flush() {
+            if (!writeBuffer() && error.empty()) {
+                error = "tinyevents: failed to write event log";
+            }
+            if (!error.empty()) {
+                throw std::runtime_error(error);
+            }
+        }
+
+    private:
+        // Called from inside dispatch(), so failures are kept for flush() instead of being thrown at the listeners' caller.
+        void write(const std::uint32_t typeId, const void* payload, const std::size_t size) {
+            if (size > std::numeric_limits<std::uint32_t>::max()) {
+                stopRecording("tinyevents: event is too large to record");
+                return;
+            }
+
+            const auto elapsed = std::chrono::steady_clock::now() - startTime;
+            const eventlog::RecordHeader header{
+                typeId,
+                static_cast<std::uint32_t>(size),
+                static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count())
+            };
+            append(&header, sizeof(header));
+            append(payload, size);
+
+            if (buffer.size() >= FlushThreshold && !writeBuffer()) {
+                stopRecording("tinyevents: failed to write event log");
+            }
+        }
+
+        void stopRecording(const char* reason) {
+            error = reason;
+            tokens.clear();
+        }
+
+        void append(const void* data, const std::size_t size) {
+            const auto* bytes = static_cast<const char*>(data);
+            buffer.insert(buffer.end(), bytes, bytes + size);
+        }
+
+        bool writeBuffer() {
+            file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            file.flush();
+            buffer.clear();
+            return static_cast<bool>(file);
+        }
+
+        Dispatcher& dispatcher;
+        std::ofstream file;
+        std::chrono::steady_clock::time_point startTime;
+        std::vector<char> buffer;
+        std::string scratch;
+        std::string error;
+        std::vector<Token> tokens;
+    };
+
+    // Reads a log written by Recorder and dispatches its events again, in the recorded order.
+    // The whole file is loaded and validated once; replaying does not allocate per event.
+    class Replayer {
+        using Decoder = std::function<void(Dispatcher&, const char*, std::size_t)>;
+    public:
+        explicit Replayer(const std::string& path) {
+            std::ifstream file(path, std::ios::binary | std::ios::ate);
+            if (!file) {
+                throw std::runtime_error("tinyevents: cannot open log file for reading: " + path);
+            }
+            const auto fileSize = file.tellg();
+            if (fileSize < 0) {
+                throw std::runtime_error("tinyevents: cannot determine size of log file: " + path);
+            }
+            data.resize(static_cast<std::size_t>(fileSize));
+            file.seekg(0);
+            if (!file.read(data.data(), static_cast<std::streamsize>(data.size()))) {
+                throw std::runtime_error("tinyevents: cannot read log file: " + path);
+            }
+
+            std::uint32_t version = 0;
+            if (data.size() < eventlog::FileHeaderSize || std::memcmp(data.data(), eventlog::Magic, sizeof(eventlog::Magic)) != 0) {
+                throw std::runtime_error("tinyevents: not an event log: " + path);
+            }
+            std::memcpy(&version, data.data() + sizeof(eventlog::Magic), sizeof(version));
+            if (version != eventlog::Version) {
+                throw std::runtime_error("tinyevents: unsupported event log version: " + path);
+            }
+
+            // Throws if the log is truncated
+            forEachRecord([this](const eventlog::RecordHeader& header, const char*) {
+                const auto [payloadSize, inserted] = payloadSizeByType.try_emplace(header.typeId, header.payloadSize);
+                if (!inserted && payloadSize->second != header.payloadSize) {
+                    payloadSize->second.reset(); // Records of this type have different sizes
+                }
+            });
+        }
+
+        // Decode records of a trivially copyable type from their raw bytes.
+        // Throws std::runtime_error if the log has records of this type with a size other than sizeof(T).
+        template<typename T>
+        void on(const std::uint32_t typeId) {
+            static_assert(std::is_trivially_copyable_v<T>, "Event must be trivially copyable or have a deserializer");
+            const auto payloadSize = payloadSizeByType.find(typeId);
+            if (payloadSize != payloadSizeByType.end() && payloadSize->second != sizeof(T)) {
+                throw std::runtime_error("tinyevents: event log record has unexpected size");
+            }
+            decoders[typeId] = [](Dispatcher& dispatcher, const char* payload, const std::size_t) {
+                alignas(T) unsigned char storage[sizeof(T)];
+                std::memcpy(storage, payload, sizeof(T));
+                dispatcher.dispatch(*std::launder(reinterpret_cast<const T*>(storage)));
+            };
+        }
+
+        // Decode records using a custom deserializer.
+        template<typename T>
+        void on(const std::uint32_t typeId, const std::function<T(const char* data, std::size_t size)>& deserializer) {
+            decoders[typeId] = [deserializer](Dispatcher& dispatcher, const char* payload, const std::size_t size) {
+                dispatcher.dispatch(deserializer(payload, size));
+            };
+        }
+
+        // Dispatch all recorded events with a registered decoder. Returns the number of dispatched events.
+        // Record sizes are validated before dispatching: the file layout when loading it, and the sizes of
+        // trivially copyable events when their decoder is registered.
+        std::size_t replay(Dispatcher& dispatcher) const {
+            std::size_t dispatched = 0;
+            forEachRecord([this, &dispatcher, &dispatched](const eventlog::RecordHeader& header, const char* payload) {
+                const auto decoder = decoders.find(header.typeId);
+                if (decoder != decoders.end()) {
+                    decoder->second(dispatcher, payload, header.payloadSize);
+                    ++dispatched;
+                }
+            });
+            return dispatched;
+        }
+
+    private:
+        template<typename Visitor>
+        void forEachRecord(Visitor&& visitor) const {
+            std::size_t offset = eventlog::FileHeaderSize;
+            while (offset < data.size()) {
+                if (data.size() - offset < sizeof(eventlog::RecordHeader)) {
+                    throw std::runtime_error("tinyevents: truncated event log");
+                }
+                eventlog::RecordHeader header{};
+                std::memcpy(&header, data.data() + offset, sizeof(header));
+                offset += sizeof(header);
+
+                if (data.size() - offset < header.payloadSize) {
+                    throw std::runtime_error("tinyevents: truncated event log");
+                }
+                visitor(header, data.data() + offset);
+                offset += header.payloadSize;
+            }
+        }
+
+        std::vector<char> data;
+        // Payload size of the records of each type, or nullopt if they have different sizes
+        std::map<std::uint32_t, std::optional<std::uint32_t>> payloadSizeByType;
+        std::map<std::uint32_t, Decoder> decoders;
+    };
+}// namespace tinyevents
@@ -1,9 +1,12 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <queue>
-#include <set>
 #include <map>
+#include <type_traits>
 #include <typeindex>
 #include <utility>
 
@@ -13,7 +16,142 @@ namespace tinyevents
 
     class Dispatcher {
         using ListenerHandle = std::uint64_t;
-        using Listeners = std::map<ListenerHandle, std::function<void(const void *)>>;
+
+        struct Listener {
+            using Callback = std::function<void(void *, const void *)>;
+
+            explicit Listener(Callback callback)
+                : callback(std::move(callback)) {}
+            Listener(Callback callback, std::weak_ptr<void> owner)
+                : callback(std::move(callback)), owner(std::move(owner)), hasOwner(true) {}
+
+            // Called with the locked owner (or nullptr if there is none) and the message
+            Callback callback;
+            std::weak_ptr<void> owner;
+            bool hasOwner = false;
+            bool once = false;
+            bool removed = false;
+
+            [[nodiscard]] bool isActive() const {
+                return !removed && !(hasOwner && owner.expired());
+            }
+        };
+        struct Listeners {
+            static constexpr std::size_t MinSweepThreshold = 16;
+
+            std::map<ListenerHandle, Listener> byHandle;
+            bool needsCompaction = false;
+            // listen() erases inactive listeners once the map grows to this size, so listeners
+            // with expired owners can't pile up when their event type is rarely dispatched.
+            std::size_t sweepThreshold = MinSweepThreshold;
+
+            void eraseInactive() {
+                for (auto it = byHandle.begin(); it != byHandle.end();) {
+                    it = it->second.isActive() ? std::next(it) : byHandle.erase(it);
+                }
+                needsCompaction = false;
+            }
+        };
+
+        // Listeners live on the heap so that tokens and listenOnce() callbacks
+        // stay valid when the dispatcher is moved.
+        struct Registry {
+            // While any dispatch is running, listeners are only flagged as removed, so that
+            // dispatches up the call stack can keep iterating. They are erased once the outermost dispatch ends.
+            void remove(const std::uint64_t handle) {
+                if (!removeFrom(listenersByType, handle)) {
+                    removeFrom(observersByType, handle);
+                }
+            }
+
+            [[nodiscard]] bool hasListener(std::uint64_t handle) const {
+                return containsActive(listenersByType, handle) || containsActive(observersByType, handle);
+            }
+
+            void scheduleCompaction(Listeners &listeners) {
+                listeners.needsCompaction = true;
+                needsCompaction = true;
+            }
+
+            void compact() {
+                compact(listenersByType);
+                compact(observersByType);
+                needsCompaction = false;
+            }
+
+            std::map<std::type_index, Listeners> listenersByType;
+            std::map<std::type_index, Listeners> observersByType;
+            std::uint64_t nextListenerId = 0;
+            std::uint32_t dispatchDepth = 0;
+            bool needsCompaction = false;
+            // Set while a dispatch that called an observer is running; observers are not called for its nested dispatches
+            bool insideObservedDispatch = false;
+
+        private:
+            bool removeFrom(std::map<std::type_index, Listeners> &listenersByTypeToSearch, const std::uint64_t handle) {
+                for (auto &[msgType, listeners]: listenersByTypeToSearch) {
+                    const auto& handleAndListener = listeners.byHandle.find(handle);
+                    if (handleAndListener == listeners.byHandle.end()) {
+                        continue;
+                    }
+
+                    if (dispatchDepth > 0) {
+                        handleAndListener->second.removed = true;
+                        scheduleCompaction(listeners);
+                    } else {
+                        listeners.byHandle.erase(handleAndListener);
+                    }
+                    return true;
+                }
+                return false;
+            }
+
+            [[nodiscard]] static bool containsActive(const std::map<std::type_index, Listeners> &listenersByTypeToSearch,
+                                                     const std::uint64_t handle) {
+                return std::any_of(listenersByTypeToSearch.begin(), listenersByTypeToSearch.end(), [&handle](const auto& listeners) {
+                    const auto& handleAndListener = listeners.second.byHandle.find(handle);
+                    return handleAndListener != listeners.second.byHandle.end() && handleAndListener->second.isActive();
+                });
+            }
+
+            static void compact(std::map<std::type_index, Listeners> &listenersByTypeToCompact) {
+                for (auto &[msgType, listeners]: listenersByTypeToCompact) {
+                    if (listeners.needsCompaction) {
+                        listeners.eraseInactive();
+                    }
+                }
+            }
+        };
+
+        // Tracks nesting of dispatch() calls and compacts the registry when the outermost one ends.
+        class DispatchScope {
+        public:
+            explicit DispatchScope(Registry &registry) : registry(registry) {
+                ++registry.dispatchDepth;
+            }
+            ~DispatchScope() {
+                if (observed) {
+                    registry.insideObservedDispatch = false;
+                }
+                if (--registry.dispatchDepth == 0 && registry.needsCompaction) {
+                    registry.compact();
+                }
+            }
+
+            DispatchScope(const DispatchScope&) = delete;
+            DispatchScope& operator=(const DispatchScope&) = delete;
+
+            void markObserved() {
+                observed = true;
+                registry.insideObservedDispatch = true;
+            }
+
+        private:
+            Registry &registry;
+            bool observed = false;
+        };
+
+        friend class Token;
     public:
         Dispatcher() = default;
         Dispatcher(Dispatcher &&) noexcept = default;
@@ -22,52 +160,64 @@ namespace tinyevents
 
         template<typename T>
         std::uint64_t listen(const std::function<void(const T &)> &listener) {
-            auto& listeners = listenersByType[std::type_index(typeid(T))];
-            const auto listenerHandle = ListenerHandle{nextListenerId++};
+            return addListener<T>(Listener{makeCallback(listener)});
+        }
 
-            listeners[listenerHandle] = [listener](const auto &msg) {
-                const T *concreteMessage = static_cast<const T *>(msg);
-                listener(*concreteMessage);
-            };
-            return listenerHandle;
+        // Bind a listener to the lifetime of its owner. Once the owner expires the listener is no longer
+        // called and is removed after the next dispatch of its event type, or when more listeners are added.
+        // The member function may come from a base class of the owner.
+        template<typename T, typename Owner, typename Class>
+        std::uint64_t listen(const std::weak_ptr<Owner> &owner, void (Class::*method)(const T &)) {
+            return addOwnedListener<T, Class>(owner, method);
+        }
+
+        template<typename T, typename Owner, typename Class>
+        std::uint64_t listen(const std::weak_ptr<Owner> &owner, void (Class::*method)(const T &) const) {
+            return addOwnedListener<T, Class>(owner, method);
+        }
+
+        template<typename T, typename Owner, typename Class>
+        std::uint64_t listen(const std::shared_ptr<Owner> &owner, void (Class::*method)(const T &)) {
+            return addOwnedListener<T, Class>(std::weak_ptr<Owner>(owner), method);
+        }
+
+        template<typename T, typename Owner, typename Class>
+        std::uint64_t listen(const std::shared_ptr<Owner> &owner, void (Class::*method)(const T &) const) {
+            return addOwnedListener<T, Class>(std::weak_ptr<Owner>(owner), method);
         }
 
         template<typename T>
         std::uint64_t listenOnce(const std::function<void(const T &)> &listener) {
-            const auto listenerId = nextListenerId;
-            return listen<T>([this, listenerId, listener](const T &msg) {
-                ListenerHandle handle{listenerId};
-                listenersScheduledForRemoval.emplace(handle); // Fix for nested listenOnce
-                listener(msg);
-                listenersScheduledForRemoval.erase(handle);
-                this->remove(handle);
-            });
+            Listener onceListener{makeCallback(listener)};
+            onceListener.once = true;
+            return addListener<T>(std::move(onceListener));
+        }
+
+        // Observe dispatches of an event type. The observer is called before any listener. Once an observer
+        // is called, no observer is called for events dispatched from inside that dispatch.
+        template<typename T>
+        std::uint64_t observe(const std::function<void(const T &)> &observer) {
+            return addListener<T>(getRegistry().observersByType, Listener{makeCallback(observer)});
         }
 
         template<typename T>
         void dispatch(const T &msg) {
-            const auto &listenersIter = listenersByType.find(std::type_index(typeid(T)));
-            if (listenersIter == listenersByType.end()) {
-                return; // No listeners for this type of message
+            if (!registry) {
+                return; // Moved-from dispatcher has no listeners
             }
 
-            const auto& [msgType, listeners] = *listenersIter;
-
-            // Cache handles to avoid iterator invalidation. This way listeners can safely remove themselves.
-            std::vector<ListenerHandle> handles;
-            handles.reserve(listeners.size());
-            for (auto &[handle, listener]: listeners) {
-                handles.push_back(handle);
-            }
+            // Listeners may move or destroy this dispatcher, so keep the registry alive until the dispatch ends
+            const std::shared_ptr<Registry> activeRegistry = registry;
+            DispatchScope scope{*activeRegistry};
+            const auto msgType = std::type_index(typeid(T));
 
-            for(auto& handle: handles) {
-                const auto& handleAndListener = listeners.find(handle);
-                const bool isListenerPresent = handleAndListener != listeners.end();
-                if (isListenerPresent && !isScheduledForRemoval(handle)) {
-                    const auto& listener = handleAndListener->second;
-                    listener(&msg);
-                }
+            // Handles only grow, so listeners added by callbacks are past `lastHandle` and are not called now.
+            const auto lastHandle = activeRegistry->nextListenerId;
+            if (!activeRegistry->insideObservedDispatch && !activeRegistry->observersByType.empty()
+                && notify(*activeRegistry, activeRegistry->observersByType, msgType, &msg, lastHandle)) {
+                scope.markObserved();
             }
+            notify(*activeRegistry, activeRegistry->listenersByType, msgType, &msg, lastHandle);
         }
 
         template<typename T>
@@ -86,45 +236,114 @@ namespace tinyevents
         }
 
         void remove(const std::uint64_t handle) {
-            if (isScheduledForRemoval(handle)) {
-                return;
+            if (registry) {
+                registry->remove(handle);
+            }
+        }
+
+        [[nodiscard]] bool hasListener(std::uint64_t handle) const {
+            return registry && registry->hasListener(handle);
+        }
+
+    private:
+        template<typename T>
+        static Listener::Callback makeCallback(const std::function<void(const T &)> &listener) {
+            return [listener](void *, const void *msg) {
+                const T *concreteMessage = static_cast<const T *>(msg);
+                listener(*concreteMessage);
+            };
+        }
+
+        // Returns true if any listener was called.
+        static bool notify(Registry &registry, std::map<std::type_index, Listeners> &listenersByType,
+                           const std::type_index msgType, const void *msg, const ListenerHandle lastHandle) {
+            const auto &listenersIter = listenersByType.find(msgType);
+            if (listenersIter == listenersByType.end()) {
+                return false; // No listeners for this type of message
             }
 
-            for (auto &listeners: listenersByType) {
-                listeners.second.erase(handle);
+            auto& listeners = listenersIter->second;
+
+            // Nothing is erased while dispatching, so iterators stay valid.
+            auto& byHandle = listeners.byHandle;
+            bool called = false;
+            for (auto it = byHandle.begin(); it != byHandle.end() && it->first < lastHandle; ++it) {
+                auto& listener = it->second;
+                if (listener.removed) {
+                    registry.scheduleCompaction(listeners);
+                    continue;
+                }
+
+                // Keep the owner alive for the duration of the call
+                std::shared_ptr<void> lockedOwner;
+                if (listener.hasOwner) {
+                    lockedOwner = listener.owner.lock();
+                    if (!lockedOwner) {
+                        listener.removed = true;
+                        registry.scheduleCompaction(listeners);
+                        continue;
+                    }
+                }
+
+                if (listener.once) {
+                    // Flag before calling, so a nested dispatch won't call it again
+                    listener.removed = true;
+                    registry.scheduleCompaction(listeners);
+                }
+                called = true;
+                listener.callback(lockedOwner.get(), msg);
             }
+            return called;
         }
 
-        [[nodiscard]] bool hasListener(std::uint64_t handle) const {
-            if (isScheduledForRemoval(handle)) {
-                return false;
+        template<typename T, typename Class, typename Owner, typename Method>
+        std::uint64_t addOwnedListener(const std::weak_ptr<Owner> &owner, Method method) {
+            static_assert(std::is_base_of_v<Class, Owner>, "Method must be a member of the owner or its base class");
+            return addListener<T>(Listener{[method](void *lockedOwner, const void *msg) {
+                (static_cast<Owner *>(lockedOwner)->*method)(*static_cast<const T *>(msg));
+            }, owner});
+        }
+
+        template<typename T>
+        std::uint64_t addListener(Listener listener) {
+            return addListener<T>(getRegistry().listenersByType, std::move(listener));
+        }
+
+        template<typename T>
+        std::uint64_t addListener(std::map<std::type_index, Listeners> &listenersByType, Listener listener) {
+            Registry &registry = getRegistry();
+            auto& listeners = listenersByType[std::type_index(typeid(T))];
+            if (registry.dispatchDepth == 0 && listeners.byHandle.size() >= listeners.sweepThreshold) {
+                listeners.eraseInactive();
+                listeners.sweepThreshold = std::max(Listeners::MinSweepThreshold, 2 * listeners.byHandle.size());
             }
 
-            return std::any_of(listenersByType.begin(), listenersByType.end(), [&handle](const auto& listeners) {
-                return listeners.second.find(handle) != listeners.second.end();
-            });
+            const auto listenerHandle = ListenerHandle{registry.nextListenerId++};
+            listeners.byHandle.emplace_hint(listeners.byHandle.end(), listenerHandle, std::move(listener));
+            return listenerHandle;
         }
 
-    private:
-        [[nodiscard]] bool isScheduledForRemoval(const std::uint64_t handle) const {
-            return listenersScheduledForRemoval.find(handle) != listenersScheduledForRemoval.end();
+        // A moved-from dispatcher gets a fresh registry when it is used again.
+        Registry &getRegistry() {
+            if (!registry) {
+                registry = std::make_shared<Registry>();
+            }
+            return *registry;
         }
 
-        std::map<std::type_index, Listeners> listenersByType;
+        std::shared_ptr<Registry> registry = std::make_shared<Registry>();
         std::queue<std::function<void(Dispatcher&)>> queuedDispatches;
-        std::set<ListenerHandle> listenersScheduledForRemoval;
-
-        std::uint64_t nextListenerId = 0;
     };
 
     // RAII wrapper for listener handle.
+    // The token follows the listeners when the dispatcher is moved and does nothing if they are already gone.
     class Token {
     public:
         Token(Dispatcher& dispatcher, const std::uint64_t handle)
-            : dispatcher(dispatcher), _handle(handle), holdsResource(true) {}
+            : registry(dispatcher.registry), _handle(handle), holdsResource(true) {}
         ~Token() {
             if (holdsResource) {
-                dispatcher.get().remove(_handle);
+                removeFromRegistry();
             }
         }
 
@@ -134,16 +353,16 @@ namespace tinyevents
 
         // Enable move operations
         Token(Token&& other) noexcept
-            : dispatcher(other.dispatcher), _handle(other._handle), holdsResource(other.holdsResource) {
+            : registry(std::move(other.registry)), _handle(other._handle), holdsResource(other.holdsResource) {
             other.holdsResource = false;
         }
 
         Token& operator=(Token&& other) noexcept {
             if (this != &other) {
                 if (this->holdsResource) {
-                    dispatcher.get().remove(_handle);
+                    removeFromRegistry();
                 }
-                dispatcher = other.dispatcher;
+                registry = std::move(other.registry);
                 _handle = other._handle;
                 holdsResource = other.holdsResource;
                 other.holdsResource = false;
@@ -156,12 +375,18 @@ namespace tinyevents
         }
 
         void remove() {
-            dispatcher.get().remove(_handle);
+            removeFromRegistry();
             holdsResource = false;
         }
 
     private:
-        std::reference_wrapper<Dispatcher> dispatcher;
+        void removeFromRegistry() const {
+            if (const auto lockedRegistry = registry.lock()) {
+                lockedRegistry->remove(_handle);
+            }
+        }
+
+        std::weak_ptr<Dispatcher::Registry> registry;
         std::uint64_t _handle;
         bool holdsResource;
     };
@@ -126,3 +126,89 @@ TEST_F(TestEventDispatch, ParentMessageTypeListenerShouldNotBeCalledForChildMess
     EXPECT_CALL(childCallback, Call(A<const Child &>())).Times(1);
     dispatcher.dispatch(Child{});
 }
+
+
+TEST_F(TestEventDispatch, ListenerRemovedInNestedDispatchIsNotCalledByOuterDispatch) {
+    StrictMock<MockFunction<void(const int &)>> callback;
+    std::uint64_t handle2{0};
+
+    dispatcher.listen<int>([&](const int &value) {
+        if (value == 111)
+            dispatcher.dispatch(std::string("remove"));
+    });
+    handle2 = dispatcher.listen(callback.AsStdFunction());
+    dispatcher.listen<std::string>([&](const std::string &) {
+        dispatcher.remove(handle2);
+        EXPECT_FALSE(dispatcher.hasListener(handle2));
+    });
+
+    EXPECT_CALL(callback, Call(_)).Times(0);
+    dispatcher.dispatch(111);
+    EXPECT_FALSE(dispatcher.hasListener(handle2));
+}
+
+TEST_F(TestEventDispatch, ListenersCanBeRemovedAfterListenerThrows) {
+    StrictMock<MockFunction<void(const int &)>> callback;
+
+    dispatcher.listenOnce<int>([](const int &) {
+        throw std::runtime_error("listener failed");
+    });
+    const auto handle = dispatcher.listen(callback.AsStdFunction());
+
+    EXPECT_THROW(dispatcher.dispatch(111), std::runtime_error);
+
+    dispatcher.remove(handle);
+    EXPECT_FALSE(dispatcher.hasListener(handle));
+    dispatcher.dispatch(222); // Neither listener is called
+}
+
+
+TEST_F(TestEventDispatch, ObserverIsCalledBeforeListeners) {
+    std::vector<std::string> calls;
+
+    dispatcher.listen<int>([&](const int &) {
+        calls.emplace_back("listener");
+    });
+    dispatcher.observe<int>([&](const int &) {
+        calls.emplace_back("observer");
+    });
+
+    dispatcher.dispatch(111);
+    EXPECT_THAT(calls, ElementsAre("observer", "listener"));
+}
+
+TEST_F(TestEventDispatch, ObserverIsNotCalledInsideObservedDispatch) {
+    StrictMock<MockFunction<void(const int &)>> observer;
+
+    dispatcher.listen<int>([&](const int &value) {
+        if (value == 111)
+            dispatcher.dispatch(222);
+    });
+    const auto handle = dispatcher.observe(observer.AsStdFunction());
+    EXPECT_TRUE(dispatcher.hasListener(handle));
+
+    EXPECT_CALL(observer, Call(111)).Times(1);
+    dispatcher.dispatch(111);
+
+    dispatcher.remove(handle);
+    EXPECT_FALSE(dispatcher.hasListener(handle));
+    dispatcher.dispatch(333);
+}
+
+TEST_F(TestEventDispatch, ObserverIsCalledForNestedDispatchWhenOuterDispatchIsNotObserved) {
+    StrictMock<MockFunction<void(const double &)>> observer;
+
+    dispatcher.listen<int>([&](const int &) {
+        dispatcher.dispatch(2.5);
+        dispatcher.dispatch(3.5);
+    });
+    dispatcher.listen<double>([&](const double &value) {
+        if (value < 5.0)
+            dispatcher.dispatch(value * 2); // Inside an observed dispatch
+    });
+    dispatcher.observe(observer.AsStdFunction());
+
+    EXPECT_CALL(observer, Call(2.5)).Times(1);
+    EXPECT_CALL(observer, Call(3.5)).Times(1);
+    dispatcher.dispatch(111);
+}
@@ -2,6 +2,8 @@
 #include <gtest/gtest.h>
 #include <tinyevents/tinyevents.hpp>
 
+#include <optional>
+
 using namespace tinyevents;
 using namespace testing;
 
@@ -45,4 +47,59 @@ TEST(TestDispatcherMove, WhenDispatcherIsMovedThenQueuedMessagesAreMoved) {
 
     EXPECT_CALL(intCallback, Call(111)).Times(1);
     dispatcher.process();
-}
\ No newline at end of file
+}
+
+TEST(TestDispatcherMove, WhenDispatcherIsMovedThenListenerOnceIsRemovedFromNewDispatcher) {
+    Dispatcher movedDispatcher;
+    StrictMock<MockFunction<void(const int &)>> intCallback;
+
+    const auto handle = movedDispatcher.listenOnce(intCallback.AsStdFunction());
+    Dispatcher dispatcher = std::move(movedDispatcher);
+
+    EXPECT_CALL(intCallback, Call(111)).Times(1);
+    dispatcher.dispatch(111);
+    EXPECT_FALSE(dispatcher.hasListener(handle));
+    dispatcher.dispatch(222);
+}
+
+TEST(TestDispatcherMove, MovedFromDispatcherCanBeUsedAgain) {
+    Dispatcher movedDispatcher;
+    StrictMock<MockFunction<void(const int &)>> intCallback;
+
+    Dispatcher dispatcher = std::move(movedDispatcher);
+    movedDispatcher.listen(intCallback.AsStdFunction()); // NOLINT(*-use-after-move)
+
+    EXPECT_CALL(intCallback, Call(111)).Times(1);
+    movedDispatcher.dispatch(111);
+}
+
+
+TEST(TestDispatcherMove, ListenerCanMoveDispatcherDuringDispatch) {
+    Dispatcher movedDispatcher;
+    std::optional<Dispatcher> dispatcher;
+    StrictMock<MockFunction<void(const int &)>> intCallback;
+
+    movedDispatcher.listen<int>([&](const int &) {
+        dispatcher.emplace(std::move(movedDispatcher));
+    });
+    const auto handle = movedDispatcher.listenOnce(intCallback.AsStdFunction());
+
+    EXPECT_CALL(intCallback, Call(111)).Times(1);
+    movedDispatcher.dispatch(111);
+    ASSERT_TRUE(dispatcher.has_value());
+    EXPECT_FALSE(dispatcher->hasListener(handle));
+}
+
+TEST(TestDispatcherMove, ListenerCanDestroyDispatcherDuringDispatch) {
+    auto dispatcher = std::make_unique<Dispatcher>();
+    StrictMock<MockFunction<void(const int &)>> intCallback;
+
+    dispatcher->listen<int>([&](const int &) {
+        dispatcher.reset();
+    });
+    dispatcher->listenOnce(intCallback.AsStdFunction());
+
+    EXPECT_CALL(intCallback, Call(111)).Times(1); // Listeners of the ongoing dispatch are still called
+    dispatcher->dispatch(111);
+    EXPECT_EQ(dispatcher, nullptr);
+}
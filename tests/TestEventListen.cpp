@@ -9,6 +9,50 @@ struct TestEventListen : public Test {
     Dispatcher dispatcher{};
 };
 
+namespace {
+    struct Subscriber {
+        MockFunction<void(const int &)> callback;
+
+        void onInt(const int &value) {
+            callback.Call(value);
+        }
+
+        void onIntConst(const int &value) const {
+            const_cast<Subscriber *>(this)->callback.Call(value);
+        }
+    };
+
+    struct DerivedSubscriber : Subscriber {
+    };
+
+    // Counts live allocations. The control block of std::allocate_shared is freed only after
+    // the last weak_ptr is gone, so this shows whether the dispatcher still stores the owner.
+    template<typename T>
+    struct CountingAllocator {
+        using value_type = T;
+
+        explicit CountingAllocator(int *live) : live(live) {}
+        template<typename U>
+        CountingAllocator(const CountingAllocator<U> &other) : live(other.live) {} // NOLINT(*-explicit-constructor)
+
+        T *allocate(std::size_t n) {
+            ++*live;
+            return std::allocator<T>{}.allocate(n);
+        }
+        void deallocate(T *p, std::size_t n) {
+            --*live;
+            std::allocator<T>{}.deallocate(p, n);
+        }
+
+        template<typename U>
+        bool operator==(const CountingAllocator<U> &other) const { return live == other.live; }
+        template<typename U>
+        bool operator!=(const CountingAllocator<U> &other) const { return live != other.live; }
+
+        int *live;
+    };
+}
+
 
 TEST_F(TestEventListen, VerifyListenerHandlePredicates) {
     // Get the type of value returned by listen
@@ -206,4 +250,123 @@ TEST_F(TestEventListen, TestRaiiApproachToListenerRemoval) {
         RaiiHandleType raiiHandle(new std::uint64_t(handle), deleter);
     }
     EXPECT_FALSE(dispatcher.hasListener(handle));
+}
+
+TEST_F(TestEventListen, ListenerBoundToOwnerShouldBeCalledWhileOwnerIsAlive) {
+    const auto subscriber = std::make_shared<Subscriber>();
+
+    const auto handle = dispatcher.listen<int>(std::weak_ptr(subscriber), &Subscriber::onInt);
+    EXPECT_TRUE(dispatcher.hasListener(handle));
+
+    EXPECT_CALL(subscriber->callback, Call(111)).Times(1);
+    dispatcher.dispatch(111);
+}
+
+TEST_F(TestEventListen, ListenerBoundToConstMethodShouldBeCalled) {
+    const auto subscriber = std::make_shared<Subscriber>();
+
+    dispatcher.listen<int>(std::weak_ptr(subscriber), &Subscriber::onIntConst);
+
+    EXPECT_CALL(subscriber->callback, Call(111)).Times(1);
+    dispatcher.dispatch(111);
+}
+
+TEST_F(TestEventListen, ListenerBoundToExpiredOwnerShouldBeRemoved) {
+    StrictMock<MockFunction<void(const int &)>> callback;
+    auto subscriber = std::make_shared<Subscriber>();
+
+    const auto boundHandle = dispatcher.listen<int>(std::weak_ptr(subscriber), &Subscriber::onInt);
+    const auto handle = dispatcher.listen(callback.AsStdFunction());
+    subscriber.reset();
+    EXPECT_FALSE(dispatcher.hasListener(boundHandle));
+
+    EXPECT_CALL(callback, Call(111)).Times(1);
+    dispatcher.dispatch(111);
+    EXPECT_FALSE(dispatcher.hasListener(boundHandle));
+    EXPECT_TRUE(dispatcher.hasListener(handle));
+}
+
+TEST_F(TestEventListen, ListenerBoundToOwnerCanBeRemoved) {
+    const auto subscriber = std::make_shared<Subscriber>();
+
+    const auto handle = dispatcher.listen<int>(std::weak_ptr(subscriber), &Subscriber::onInt);
+    dispatcher.remove(handle);
+
+    EXPECT_CALL(subscriber->callback, Call(_)).Times(0);
+    dispatcher.dispatch(111);
+}
+
+TEST_F(TestEventListen, OwnerCanExpireDuringDispatch) {
+    auto subscriber = std::make_shared<Subscriber>();
+
+    dispatcher.listen<int>([&](const int &) {
+        subscriber.reset();
+    });
+    const auto boundHandle = dispatcher.listen<int>(std::weak_ptr(subscriber), &Subscriber::onInt);
+
+    dispatcher.dispatch(111); // Subscriber is already destroyed when its turn comes
+    EXPECT_FALSE(dispatcher.hasListener(boundHandle));
+}
+
+TEST_F(TestEventListen, ListenerOnceShouldBeCalledOnceWhenDispatchedFromNestedListener) {
+    StrictMock<MockFunction<void(const int &)>> callback;
+
+    dispatcher.listen<std::string>([&](const std::string &) {
+        dispatcher.dispatch(222);
+    });
+    const auto handle = dispatcher.listenOnce<int>([&](const int &value) {
+        callback.Call(value);
+        dispatcher.dispatch(std::string("nested"));
+    });
+
+    EXPECT_CALL(callback, Call(111)).Times(1);
+    dispatcher.dispatch(111);
+    EXPECT_FALSE(dispatcher.hasListener(handle));
+}
+
+
+TEST_F(TestEventListen, ListenerBoundToExpiredOwnerShouldBeErasedByDispatch) {
+    int live = 0;
+    auto subscriber = std::allocate_shared<Subscriber>(CountingAllocator<Subscriber>{&live});
+
+    dispatcher.listen<int>(std::weak_ptr(subscriber), &Subscriber::onInt);
+    subscriber.reset();
+    EXPECT_EQ(live, 1); // Control block is kept by the listener
+
+    dispatcher.dispatch(111);
+    EXPECT_EQ(live, 0);
+}
+
+TEST_F(TestEventListen, ListenersBoundToExpiredOwnersShouldNotPileUpWithoutDispatch) {
+    int live = 0;
+
+    for (int i = 0; i < 1000; ++i) {
+        auto subscriber = std::allocate_shared<Subscriber>(CountingAllocator<Subscriber>{&live});
+        dispatcher.listen<int>(std::weak_ptr(subscriber), &Subscriber::onInt);
+    }
+
+    EXPECT_LT(live, 100);
+}
+
+TEST_F(TestEventListen, ListenerBoundToOwnerCanUseMethodOfBaseClass) {
+    const auto subscriber = std::make_shared<DerivedSubscriber>();
+
+    dispatcher.listen<int>(std::weak_ptr(subscriber), &DerivedSubscriber::onInt);
+    dispatcher.listen<int>(std::weak_ptr(subscriber), &DerivedSubscriber::onIntConst);
+
+    EXPECT_CALL(subscriber->callback, Call(111)).Times(2);
+    dispatcher.dispatch(111);
+}
+
+TEST_F(TestEventListen, ListenerCanBeBoundToSharedOwnerDirectly) {
+    auto subscriber = std::make_shared<DerivedSubscriber>();
+
+    const auto handle = dispatcher.listen<int>(subscriber, &Subscriber::onInt);
+    dispatcher.listen(subscriber, &Subscriber::onIntConst); // Event type deduced from the method
+
+    EXPECT_CALL(subscriber->callback, Call(111)).Times(2);
+    dispatcher.dispatch(111);
+
+    subscriber.reset(); // The dispatcher must not keep the owner alive
+    EXPECT_FALSE(dispatcher.hasListener(handle));
 }
\ No newline at end of file
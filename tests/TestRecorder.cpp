@@ -0,0 +1,286 @@
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <tinyevents/recorder.hpp>
+
+#include <cstdio>
+#include <fstream>
+
+using namespace tinyevents;
+using namespace testing;
+
+namespace {
+    struct Position {
+        int x;
+        int y;
+    };
+
+    bool operator==(const Position &lhs, const Position &rhs) {
+        return lhs.x == rhs.x && lhs.y == rhs.y;
+    }
+
+    constexpr std::uint32_t IntEvent = 1;
+    constexpr std::uint32_t PositionEvent = 2;
+    constexpr std::uint32_t StringEvent = 3;
+    constexpr std::uint32_t DoubleEvent = 4;
+}
+
+struct TestRecorder : public Test {
+    Dispatcher dispatcher{};
+    // Each test uses its own file, so tests can run in parallel
+    const std::string path = std::string("tinyevents_") + UnitTest::GetInstance()->current_test_info()->name() + ".bin";
+
+    void TearDown() override {
+        std::remove(path.c_str());
+    }
+};
+
+TEST_F(TestRecorder, RecordedEventsAreReplayedInOrder) {
+    {
+        Recorder recorder(dispatcher, path);
+        recorder.record<int>(IntEvent);
+        recorder.record<Position>(PositionEvent);
+
+        dispatcher.dispatch(111);
+        dispatcher.dispatch(Position{1, 2});
+        dispatcher.dispatch(222);
+    }
+
+    StrictMock<MockFunction<void(const int &)>> intCallback;
+    StrictMock<MockFunction<void(const Position &)>> positionCallback;
+    Dispatcher replayed;
+    replayed.listen(intCallback.AsStdFunction());
+    replayed.listen(positionCallback.AsStdFunction());
+
+    Replayer replayer(path);
+    replayer.on<int>(IntEvent);
+    replayer.on<Position>(PositionEvent);
+
+    InSequence sequence;
+    EXPECT_CALL(intCallback, Call(111)).Times(1);
+    EXPECT_CALL(positionCallback, Call(Position{1, 2})).Times(1);
+    EXPECT_CALL(intCallback, Call(222)).Times(1);
+    EXPECT_EQ(replayer.replay(replayed), 3u);
+}
+
+TEST_F(TestRecorder, QueuedEventsAreRecordedWhenProcessed) {
+    {
+        Recorder recorder(dispatcher, path);
+        recorder.record<int>(IntEvent);
+
+        dispatcher.queue(111);
+        dispatcher.queue(222);
+        dispatcher.process();
+    }
+
+    StrictMock<MockFunction<void(const int &)>> intCallback;
+    Dispatcher replayed;
+    replayed.listen(intCallback.AsStdFunction());
+
+    Replayer replayer(path);
+    replayer.on<int>(IntEvent);
+
+    EXPECT_CALL(intCallback, Call(111)).Times(1);
+    EXPECT_CALL(intCallback, Call(222)).Times(1);
+    EXPECT_EQ(replayer.replay(replayed), 2u);
+}
+
+TEST_F(TestRecorder, EventsWithSerializerAreReplayed) {
+    {
+        Recorder recorder(dispatcher, path);
+        recorder.record<std::string>(StringEvent, [](std::string &out, const std::string &msg) {
+            out.append(msg);
+        });
+
+        dispatcher.dispatch(std::string("hello"));
+        dispatcher.dispatch(std::string(""));
+    }
+
+    StrictMock<MockFunction<void(const std::string &)>> stringCallback;
+    Dispatcher replayed;
+    replayed.listen(stringCallback.AsStdFunction());
+
+    Replayer replayer(path);
+    replayer.on<std::string>(StringEvent, [](const char *data, std::size_t size) {
+        return std::string(data, size);
+    });
+
+    EXPECT_CALL(stringCallback, Call("hello")).Times(1);
+    EXPECT_CALL(stringCallback, Call("")).Times(1);
+    EXPECT_EQ(replayer.replay(replayed), 2u);
+}
+
+TEST_F(TestRecorder, RecordsWithoutDecoderAreSkipped) {
+    {
+        Recorder recorder(dispatcher, path);
+        recorder.record<int>(IntEvent);
+        recorder.record<Position>(PositionEvent);
+
+        dispatcher.dispatch(Position{1, 2});
+        dispatcher.dispatch(111);
+    }
+
+    StrictMock<MockFunction<void(const int &)>> intCallback;
+    Dispatcher replayed;
+    replayed.listen(intCallback.AsStdFunction());
+
+    Replayer replayer(path);
+    replayer.on<int>(IntEvent);
+
+    EXPECT_CALL(intCallback, Call(111)).Times(1);
+    EXPECT_EQ(replayer.replay(replayed), 1u);
+}
+
+TEST_F(TestRecorder, RecorderStopsListeningWhenDestroyed) {
+    {
+        Recorder recorder(dispatcher, path);
+        recorder.record<int>(IntEvent);
+        dispatcher.dispatch(111);
+    }
+    dispatcher.dispatch(222);
+
+    Dispatcher replayed;
+    Replayer replayer(path);
+    replayer.on<int>(IntEvent);
+    EXPECT_EQ(replayer.replay(replayed), 1u); // Only the event dispatched while recording
+}
+
+TEST_F(TestRecorder, WriteFailureIsReportedByFlushInsteadOfDispatch) {
+    const std::string fullDevice = "/dev/full"; // Every write fails with "no space left on device"
+    if (!std::ofstream(fullDevice)) {
+        GTEST_SKIP() << fullDevice << " is not available";
+    }
+
+    Recorder recorder(dispatcher, fullDevice);
+    recorder.record<int>(IntEvent);
+
+    for (int i = 0; i < 10000; ++i) { // Enough events to fill the buffer several times
+        EXPECT_NO_THROW(dispatcher.dispatch(i));
+    }
+    EXPECT_THROW(recorder.flush(), std::runtime_error);
+    EXPECT_THROW(recorder.flush(), std::runtime_error); // The failure is not forgotten
+}
+
+TEST_F(TestRecorder, ReplayerRejectsFileThatIsNotAnEventLog) {
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "not an event log";
+    }
+
+    EXPECT_THROW(Replayer{path}, std::runtime_error);
+}
+
+TEST_F(TestRecorder, ReplayerRejectsTruncatedLogBeforeDispatchingAnything) {
+    {
+        Recorder recorder(dispatcher, path);
+        recorder.record<Position>(PositionEvent);
+        dispatcher.dispatch(Position{1, 2});
+        dispatcher.dispatch(Position{3, 4});
+    }
+    {
+        std::string contents;
+        {
+            std::ifstream file(path, std::ios::binary);
+            contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(contents.data(), static_cast<std::streamsize>(contents.size() - 1));
+    }
+
+    EXPECT_THROW(Replayer{path}, std::runtime_error);
+}
+
+
+TEST_F(TestRecorder, EventsDispatchedInsideRecordedDispatchAreNotRecorded) {
+    const auto dispatchNested = [this](const int &) {
+        dispatcher.dispatch(2.5);
+    };
+    dispatcher.listen<int>(dispatchNested);
+    {
+        Recorder recorder(dispatcher, path);
+        recorder.record<int>(IntEvent);
+        recorder.record<double>(DoubleEvent);
+
+        dispatcher.dispatch(1);
+        dispatcher.dispatch(3.5);
+    }
+
+    StrictMock<MockFunction<void(const int &)>> intCallback;
+    StrictMock<MockFunction<void(const double &)>> doubleCallback;
+    Dispatcher replayed;
+    replayed.listen<int>([&](const int &value) {
+        intCallback.Call(value);
+        replayed.dispatch(2.5);
+    });
+    replayed.listen(doubleCallback.AsStdFunction());
+
+    Replayer replayer(path);
+    replayer.on<int>(IntEvent);
+    replayer.on<double>(DoubleEvent);
+
+    InSequence sequence;
+    EXPECT_CALL(intCallback, Call(1)).Times(1);
+    EXPECT_CALL(doubleCallback, Call(2.5)).Times(1);
+    EXPECT_CALL(doubleCallback, Call(3.5)).Times(1);
+    EXPECT_EQ(replayer.replay(replayed), 2u);
+}
+
+TEST_F(TestRecorder, NestedDispatchIsRecordedWhenOuterEventIsNotRecorded) {
+    const auto dispatchNested = [this](const int &value) {
+        dispatcher.dispatch(Position{value, value});
+    };
+    dispatcher.listen<int>(dispatchNested);
+    {
+        Recorder recorder(dispatcher, path);
+        recorder.record<Position>(PositionEvent);
+
+        dispatcher.dispatch(1);
+        dispatcher.dispatch(2);
+    }
+
+    StrictMock<MockFunction<void(const Position &)>> positionCallback;
+    Dispatcher replayed;
+    replayed.listen(positionCallback.AsStdFunction());
+
+    Replayer replayer(path);
+    replayer.on<Position>(PositionEvent);
+
+    InSequence sequence;
+    EXPECT_CALL(positionCallback, Call(Position{1, 1})).Times(1);
+    EXPECT_CALL(positionCallback, Call(Position{2, 2})).Times(1);
+    EXPECT_EQ(replayer.replay(replayed), 2u);
+}
+
+TEST_F(TestRecorder, DecoderIsRejectedWhenRecordsHaveUnexpectedSize) {
+    {
+        Recorder recorder(dispatcher, path);
+        recorder.record<int>(IntEvent);
+        recorder.record<Position>(PositionEvent);
+        dispatcher.dispatch(111);
+        dispatcher.dispatch(Position{1, 2});
+    }
+
+    StrictMock<MockFunction<void(const int &)>> intCallback;
+    Dispatcher replayed;
+    replayed.listen(intCallback.AsStdFunction());
+
+    Replayer replayer(path);
+    replayer.on<int>(IntEvent);
+    EXPECT_THROW(replayer.on<int>(PositionEvent), std::runtime_error); // Wrong type for the recorded records
+
+    EXPECT_CALL(intCallback, Call(111)).Times(1);
+    EXPECT_EQ(replayer.replay(replayed), 1u);
+}
+
+TEST_F(TestRecorder, DecoderIsRejectedWhenRecordsHaveDifferentSizes) {
+    {
+        Recorder recorder(dispatcher, path);
+        recorder.record<std::string>(StringEvent, [](std::string &out, const std::string &msg) {
+            out.append(msg);
+        });
+        dispatcher.dispatch(std::string("abcd")); // Same size as int
+        dispatcher.dispatch(std::string("ab"));
+    }
+
+    Replayer replayer(path);
+    EXPECT_THROW(replayer.on<int>(StringEvent), std::runtime_error);
+}
@@ -65,3 +65,24 @@ TEST_F(TestToken, WhenTokenIsMovedAssignedThenHandleIsNotRemovedFromDispatcher)
     ASSERT_TRUE(dispatcher.hasListener(handle1));
     ASSERT_FALSE(dispatcher.hasListener(handle2));
 }
+
+
+TEST_F(TestToken, WhenDispatcherIsMovedThenTokenRemovesHandleFromNewDispatcher) {
+    const auto handle = dispatcher.listen<int>(nullptr);
+    const auto token = new Token(dispatcher, handle);
+
+    Dispatcher newDispatcher = std::move(dispatcher);
+    EXPECT_TRUE(newDispatcher.hasListener(handle));
+
+    delete token;
+    EXPECT_FALSE(newDispatcher.hasListener(handle));
+}
+
+TEST(TestTokenLifetime, WhenDispatcherIsDestroyedThenTokenCanStillBeDestroyed) {
+    const auto dispatcher = new Dispatcher();
+    const auto token = new Token(*dispatcher, dispatcher->listen<int>(nullptr));
+
+    delete dispatcher;
+    token->remove(); // Nothing happens
+    delete token;
+}